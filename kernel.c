@@ -1,7 +1,15 @@
 #include "memory_map.h"
+#include "latency.h"
 
 extern void scheduler_start();
-extern void sbi_putchar(char c);
+
+// UART del virt de QEMU: mismo destino que el resto de la salida baremetal
+#define UART0 ((volatile unsigned char *)0x10000000)
+
+static void uart_putc(char c)
+{
+    *UART0 = (unsigned char)c;
+}
 
 void kernel_start(int *temps, int len)
 {
@@ -11,17 +19,107 @@ void kernel_start(int *temps, int len)
     temps_index = 0;
     interrupt_count_p1 = 0;
     
-    // Print kernel start
-    sbi_putchar('K');
-    sbi_putchar('E');
-    sbi_putchar('R');
-    sbi_putchar('N');
-    sbi_putchar('E');
-    sbi_putchar('L');
-    sbi_putchar(':');
-    sbi_putchar('S');
-    sbi_putchar('\n');
+    // Print kernel start (UART directo: sbi_putchar no es una escritura de consola)
+    uart_putc('K');
+    uart_putc('E');
+    uart_putc('R');
+    uart_putc('N');
+    uart_putc('E');
+    uart_putc('L');
+    uart_putc(':');
+    uart_putc('S');
+    uart_putc('\n');
     
     // Llamar al scheduler
     scheduler_start();
 }
+
+// =============================================================================
+// Reporte de latencia muestra → actuación (llamado desde scenario_done)
+// =============================================================================
+
+static void print_str(const char *s)
+{
+    while (*s)
+        uart_putc(*s++);
+}
+
+static void print_uint(unsigned int v)
+{
+    char buf[10];
+    int n = 0;
+
+    do {
+        buf[n++] = '0' + (v % 10);
+        v /= 10;
+    } while (v != 0);
+
+    while (n > 0)
+        uart_putc(buf[--n]);
+}
+
+// sum / count sin __udivdi3 (-nostdlib no enlaza libgcc): división larga
+// de la mitad baja bit a bit sobre el resto de la mitad alta
+static unsigned int avg_u64(unsigned long long sum, unsigned int count)
+{
+    unsigned int hi = (unsigned int)(sum >> 32);
+    unsigned int lo = (unsigned int)sum;
+    unsigned int rem = hi % count;
+    unsigned int q = 0;
+    int i;
+
+    // hi / count es 0: el promedio nunca supera max, que cabe en 32 bits
+    for (i = 31; i >= 0; i--) {
+        unsigned int carry = rem >> 31;
+        rem = (rem << 1) | ((lo >> i) & 1);
+        if (carry || rem >= count) {
+            rem -= count;
+            q |= 1u << i;
+        }
+    }
+    return q;
+}
+
+static void print_latency_stage(const char *name, const LatencyStats *s,
+                                unsigned int superseded)
+{
+    // Toda muestra publicada se consume, se pisa o queda pendiente al final
+    unsigned int pending = sample_seq - s->count - superseded;
+    int b;
+
+    print_str(name);
+    print_str(" n=");
+    print_uint(s->count);
+    if (s->count != 0) {
+        print_str(" min=");
+        print_uint(s->min);
+        print_str(" avg=");
+        print_uint(avg_u64(s->sum, s->count));
+        print_str(" max=");
+        print_uint(s->max);
+    }
+    print_str(" pisadas=");
+    print_uint(superseded);
+    print_str(" pendientes=");
+    print_uint(pending);
+    uart_putc('\n');
+
+    for (b = 0; b < LAT_HIST_BUCKETS; b++) {
+        if (s->hist[b] == 0)
+            continue;
+        print_str("  [");
+        print_uint(b == 0 ? 0 : 1u << b);
+        uart_putc(',');
+        print_uint((2u << b) - 1);
+        print_str("] ");
+        print_uint(s->hist[b]);
+        uart_putc('\n');
+    }
+}
+
+void latency_report(void)
+{
+    print_str("LATENCIA (ciclos)\n");
+    print_latency_stage("P1>P2", &lat_p1_p2, superseded_p2);
+    print_latency_stage("P1>P3", &lat_p1_p3, superseded_p3);
+}
@@ -0,0 +1,25 @@
+#include "latency.h"
+
+LatencyStats lat_p1_p2;
+LatencyStats lat_p1_p3;
+
+void latency_record(LatencyStats *s, unsigned int stamp, unsigned int now)
+{
+    unsigned int delta = now - stamp;
+    unsigned int v = delta;
+    int b = 0;
+
+    if (s->count == 0 || delta < s->min)
+        s->min = delta;
+    if (delta > s->max)
+        s->max = delta;
+    s->sum += delta;
+    s->count++;
+
+    // Bucket = posición del bit más significativo
+    while ((v >> 1) != 0 && b < LAT_HIST_BUCKETS - 1) {
+        v >>= 1;
+        b++;
+    }
+    s->hist[b]++;
+}
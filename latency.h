@@ -0,0 +1,35 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+// =============================================================================
+// DISTRIBUCIÓN DE LATENCIA POR ETAPA
+// =============================================================================
+// Baremetal: deltas en ciclos (rdcycle, 32 bits bajos)
+// Emulación C: deltas en microsegundos (CLOCK_MONOTONIC)
+//
+// Histograma en potencias de 2: el bucket b cuenta deltas en [2^b, 2^(b+1)),
+// el bucket 0 incluye además el delta 0.
+//
+// Toda muestra publicada por P1 termina consumida, pisada (superseded_p*) o
+// pendiente al final. P3 busca muestras nuevas por sample_seq antes de salir (en C
+// P2 y P3 hacen una última pasada), así que el fin del bucle no deja
+// pendientes. Excepción: en S3 (P2→P1→P3) el bucle termina tras P1 y P2 nunca
+// actúa sobre la última muestra; ese pendiente lo impone el orden del escenario.
+
+#define LAT_HIST_BUCKETS 32
+
+typedef struct {
+    unsigned int count;
+    unsigned long long sum;        // 64 bits: con 32, 100 muestras de ~43M ciclos ya desbordan
+    unsigned int min;
+    unsigned int max;
+    unsigned int hist[LAT_HIST_BUCKETS];
+} LatencyStats;
+
+extern LatencyStats lat_p1_p2;     // P1 lee temps_ptr[i] → P2 actualiza el cooler
+extern LatencyStats lat_p1_p3;     // P1 lee temps_ptr[i] → P3 emite por UART
+
+// Registra now - stamp en la etapa s (aritmética modular: tolera el wrap)
+void latency_record(LatencyStats *s, unsigned int stamp, unsigned int now);
+
+#endif
@@ -36,3 +36,13 @@ unsigned long total_syscalls = 0;
 unsigned long long cycle_start = 0;
 unsigned long long cycle_end = 0;
 unsigned long long total_cycles = 0;
+
+// =============================================================================
+// LATENCIA MUESTRA → ACTUACIÓN (P1→P2, P1→P3)
+// =============================================================================
+unsigned int sample_stamp = 0;
+unsigned int sample_seq = 0;
+unsigned int p2_seen_seq = 0;
+unsigned int p3_seen_seq = 0;
+unsigned int superseded_p2 = 0;
+unsigned int superseded_p3 = 0;
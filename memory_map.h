@@ -51,6 +51,19 @@ extern unsigned long long cycle_start;
 extern unsigned long long cycle_end;
 extern unsigned long long total_cycles;
 
+// =============================================================================
+// LATENCIA MUESTRA → ACTUACIÓN (P1→P2, P1→P3)
+// =============================================================================
+// P1 etiqueta cada muestra con el ciclo en que la leyó de temps_ptr[] y un
+// número de secuencia; P2 y P3 registran el delta al actuar sobre ella.
+
+extern unsigned int sample_stamp;      // Ciclo de adquisición de la última muestra
+extern unsigned int sample_seq;        // Nº de muestra publicada (index + 1), 0 = ninguna
+extern unsigned int p2_seen_seq;       // Última muestra consumida por P2 (cooler)
+extern unsigned int p3_seen_seq;       // Última muestra emitida por P3 (UART)
+extern unsigned int superseded_p2;     // Muestras pisadas antes de que P2 las leyera
+extern unsigned int superseded_p3;     // Muestras pisadas antes de que P3 las emitiera
+
 #define STACK_SIZE 1024
 
 // IDs de los procesos
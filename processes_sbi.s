@@ -15,6 +15,15 @@
 .extern temps_len
 .extern temps_index
 .extern interrupt_count_p1
+.extern sample_stamp
+.extern sample_seq
+.extern p2_seen_seq
+.extern p3_seen_seq
+.extern superseded_p2
+.extern superseded_p3
+.extern lat_p1_p2
+.extern lat_p1_p3
+.extern latency_record
 
 # ============================================================================
 # PROCESS 1: Lectura preemptiva de UNA temperatura por invocación
@@ -44,6 +53,41 @@ process1_temp_sbi:
     add t2, t0, t2         # t2 = &temps[index]
     lw t4, 0(t2)           # t4 = temps[index] (temperatura)
     
+    # Etiquetar la muestra con su ciclo de adquisición
+    rdcycle t6
+    la t5, sample_stamp
+    sw t6, 0(t5)
+    
+    # Si P2/P3 no consumieron la muestra anterior, queda pisada
+    la t5, sample_seq
+    lw t6, 0(t5)           # t6 = secuencia de la muestra anterior
+    beqz t6, p1_publish    # Primera muestra: nada que pisar
+    
+    la t0, p2_seen_seq
+    lw t0, 0(t0)
+    beq t0, t6, p1_check_p3
+    la t0, superseded_p2
+    lw t2, 0(t0)
+    addi t2, t2, 1
+    sw t2, 0(t0)
+
+p1_check_p3:
+    la t0, p3_seen_seq
+    lw t0, 0(t0)
+    beq t0, t6, p1_publish
+    la t0, superseded_p3
+    lw t2, 0(t0)
+    addi t2, t2, 1
+    sw t2, 0(t0)
+
+p1_publish:
+    # Publicar secuencia (index + 1) y dejar la muestra en uart_buffer para P3
+    # (P3 detecta la muestra nueva por sample_seq, no por uart_buffer != 0)
+    addi t6, t1, 1
+    sw t6, 0(t5)
+    la t5, uart_buffer
+    sw t4, 0(t5)
+    
     # Guardar temperatura actual
     la t5, temp_actual
     sw t4, 0(t5)
@@ -222,6 +266,25 @@ p2_cooler_off:
     sb t1, 0(t0)
 
 p2_continue:
+    # Latencia P1→P2: registrar solo si hay una muestra nueva
+    la t1, sample_seq
+    lw t2, 0(t1)
+    la t3, p2_seen_seq
+    lw t4, 0(t3)
+    beq t2, t4, p2_print_temp
+    sw t2, 0(t3)
+    
+    la t1, sample_stamp
+    lw a1, 0(t1)           # a1 = stamp de adquisición
+    rdcycle a2             # a2 = ciclo de actuación
+    la a0, lat_p1_p2
+    addi sp, sp, -4
+    sw ra, 0(sp)
+    call latency_record
+    lw ra, 0(sp)
+    addi sp, sp, 4
+
+p2_print_temp:
     # Leer temp_actual
     la t1, temp_actual
     lw t2, 0(t1)
@@ -266,6 +329,15 @@ process3_uart_sbi:
     la t2, cycle_count_p3
     sw t0, 0(t2)
     
+    # ¿Muestra nueva? Se decide por secuencia, no por valor (0°C es válido).
+    # Se comprueba ANTES que temps_index: P1 publica la última muestra e
+    # incrementa el índice antes de que P3 corra, y esa muestra debe emitirse
+    la t2, sample_seq
+    lw t2, 0(t2)                # t2 = secuencia publicada por P1
+    la t3, p3_seen_seq
+    lw t5, 0(t3)                # t5 = última secuencia emitida
+    bne t2, t5, p3_emit         # Muestra nueva: emitir aunque P1 haya terminado
+    
     # Check if system still active (temps_index < temps_len)
     la t3, temps_index
     lw t4, 0(t3)
@@ -273,20 +345,25 @@ process3_uart_sbi:
     lw t6, 0(t5)
     bge t4, t6, p3_done         # If done processing, exit
     
-    # Read from UART buffer (check one time for data)
+    j p3_return                 # Sin muestra nueva, just return
+
+p3_emit:
+    # Marcar la muestra como consumida por P3
+    sw t2, 0(t3)
+    
+    # Read from UART buffer
     la t0, uart_buffer
     lw t1, 0(t0)
     
-    beqz t1, p3_return          # If buffer empty, just return
-    
     # Save last received datum
     la t2, uart_last
     sw t1, 0(t2)
     
     # Clear buffer
     sw zero, 0(t0)
+    mv t4, t1                   # t4 = muestra a emitir
     
-    # Print received data marker con identificador P3
+    # Emitir la muestra con identificador P3 (formato: P3:R:XX, 3 dígitos si >= 100)
     li t0, 0x10000000
     li t1, 'P'
     sb t1, 0(t0)
@@ -299,6 +376,38 @@ process3_uart_sbi:
     li t1, ':'
     sb t1, 0(t0)
     
+    # Centena (solo si la muestra es >= 100)
+    li t2, 100
+    blt t4, t2, p3_print_tens
+    div t3, t4, t2         # t3 = centena
+    rem t4, t4, t2         # t4 = resto
+    addi t3, t3, 48
+    sb t3, 0(t0)
+
+p3_print_tens:
+    # Decena y unidad
+    li t2, 10
+    div t3, t4, t2         # t3 = decena
+    rem t4, t4, t2         # t4 = unidad
+    addi t3, t3, 48
+    sb t3, 0(t0)
+    addi t4, t4, 48
+    sb t4, 0(t0)
+    
+    li t1, ' '
+    sb t1, 0(t0)
+    
+    # Latencia P1→P3: la muestra ya salió por UART
+    la t1, sample_stamp
+    lw a1, 0(t1)           # a1 = stamp de adquisición
+    rdcycle a2             # a2 = ciclo de emisión
+    la a0, lat_p1_p3
+    addi sp, sp, -4
+    sw ra, 0(sp)
+    call latency_record
+    lw ra, 0(sp)
+    addi sp, sp, 4
+    
 p3_return:
     # Retornar para que se ejecute el siguiente proceso
     ret
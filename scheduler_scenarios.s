@@ -19,6 +19,7 @@
 .extern cycle_start
 .extern cycle_end
 .extern total_cycles
+.extern latency_report
 
 # Macro para incrementar un contador (dirección en t7, valor en t8)
 .macro inc_counter addr_reg, val_reg
@@ -556,6 +557,9 @@ hex_digit_print_final:
     li t2, '\n'
     sb t2, 0(t0)
     
+    # Distribución de latencia P1→P2 / P1→P3 y muestras pisadas
+    call latency_report
+    
     # LOOP INFINITO - SIN REINICIAR scenario_done
 scenario_final_loop:
     j scenario_final_loop
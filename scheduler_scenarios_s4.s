@@ -18,6 +18,7 @@
 .extern cycle_start
 .extern cycle_end
 .extern total_cycles
+.extern latency_report
 
 # ============================================================================
 # MAIN SCHEDULER - Escenario 4 SOLO
@@ -261,6 +262,9 @@ hex_digit_print_final:
     li t2, '\n'
     sb t2, 0(t0)
     
+    # Distribución de latencia P1→P2 / P1→P3 y muestras pisadas
+    call latency_report
+    
     # LOOP INFINITO
 scenario_final_loop:
     j scenario_final_loop
@@ -8,6 +8,7 @@
 #include <malloc.h>
 #include <string.h>
 #include "memory_map.h"
+#include "latency.h"
 
 // Métricas por proceso
 typedef struct {
@@ -43,6 +44,15 @@ int temp_snapshot_count = 0;
 pthread_mutex_t temp_snapshot_mutex = PTHREAD_MUTEX_INITIALIZER;
 struct timespec temp_monitor_start;
 
+// Etiquetado de muestras (P1 publica valor + stamp + secuencia de forma atómica)
+pthread_mutex_t sample_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Equivalente a rdcycle en la emulación: microsegundos de CLOCK_MONOTONIC (32 bits)
+static unsigned int sample_clock_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
 
 
 // Process1: Simula Process1_temp.s (lee temperaturas, actualiza flags)
@@ -57,8 +67,19 @@ void* process1_assembly_logic(void* arg) {
         // P1_loop: cargar índice actual
         int idx = temps_index;
         
-        // Leer temperatura del array
+        // Leer temperatura del array y etiquetarla con su instante de adquisición
         int val = temps_ptr[idx];
+        unsigned int stamp = sample_clock_us();
+        
+        pthread_mutex_lock(&sample_mutex);
+        
+        // Si P2/P3 no consumieron la muestra anterior, queda pisada
+        if (sample_seq != 0) {
+            if (p2_seen_seq != sample_seq) superseded_p2++;
+            if (p3_seen_seq != sample_seq) superseded_p3++;
+        }
+        sample_stamp = stamp;
+        sample_seq = idx + 1;
         
         // Guardar temperatura actual
         temp_actual = val;
@@ -77,6 +98,8 @@ void* process1_assembly_logic(void* arg) {
         // Escribir en uart_buffer para transmisión
         uart_buffer = val;
         
+        pthread_mutex_unlock(&sample_mutex);
+        
         // Capturar snapshot cada 5 iteraciones
         if (temps_index % 5 == 0 && temp_snapshot_count < MAX_TEMP_SNAPSHOTS) {
             pthread_mutex_lock(&temp_snapshot_mutex);
@@ -105,6 +128,25 @@ void* process1_assembly_logic(void* arg) {
     return NULL;
 }
 
+// P2: actualizar cooling_state según cooling_flag (una pasada)
+static void process2_cooler_update(void) {
+    pthread_mutex_lock(&sample_mutex);
+    if (cooling_flag) {
+        // Cooling activo
+        cooling_state = 1;
+    } else {
+        // Cooling inactivo
+        cooling_state = 0;
+    }
+    
+    // Latencia P1→P2: solo la primera vez que se actúa sobre cada muestra
+    if (sample_seq != p2_seen_seq) {
+        p2_seen_seq = sample_seq;
+        latency_record(&lat_p1_p2, sample_stamp, sample_clock_us());
+    }
+    pthread_mutex_unlock(&sample_mutex);
+}
+
 // Process2: Cooler Monitor (monitorea el sistema de enfriamiento)
 void* process2_assembly_logic(void* arg) {
     clock_gettime(CLOCK_MONOTONIC, &metrics_p2.start_time);
@@ -128,22 +170,36 @@ void* process2_assembly_logic(void* arg) {
         // Los snapshots se capturan en P1, así que muestran el estado en ese instante,
         // pero P2 podría estar ejecutándose en otro CPU core.
         
-        if (cooling_flag) {
-            // Cooling activo
-            cooling_state = 1;
-        } else {
-            // Cooling inactivo
-            cooling_state = 0;
-        }
+        process2_cooler_update();
         
         // Simular tiempo de monitoreo
         usleep(1000);
     }
     
+    // Actuar sobre la última muestra publicada antes de salir (igual que P3)
+    process2_cooler_update();
+    
     clock_gettime(CLOCK_MONOTONIC, &metrics_p2.end_time);
     return NULL;
 }
 
+// P3: leer uart_buffer y emitir la muestra (una pasada)
+static void process3_uart_poll(void) {
+    pthread_mutex_lock(&sample_mutex);
+    // Muestra nueva según sample_seq (no según el valor: 0°C es válido)
+    if (sample_seq != p3_seen_seq) {
+        // Dato disponible en buffer
+        uart_last = uart_buffer;
+        // En el hardware real se envía por UART
+        // Aquí simplemente registramos la lectura
+        
+        // Latencia P1→P3: muestra emitida por primera vez
+        p3_seen_seq = sample_seq;
+        latency_record(&lat_p1_p3, sample_stamp, sample_clock_us());
+    }
+    pthread_mutex_unlock(&sample_mutex);
+}
+
 // Process3: UART Transmitter (transmite datos)
 void* process3_assembly_logic(void* arg) {
     clock_gettime(CLOCK_MONOTONIC, &metrics_p3.start_time);
@@ -154,21 +210,45 @@ void* process3_assembly_logic(void* arg) {
         metrics_p3.context_switches++;
         
         // P3_loop: leer uart_buffer
-        if (uart_buffer != 0) {
-            // Dato disponible en buffer
-            uart_last = uart_buffer;
-            // En el hardware real se envía por UART
-            // Aquí simplemente registramos la lectura
-        }
+        process3_uart_poll();
         
         // Simular tiempo de transmisión
         usleep(1000);
     }
     
+    // P1 publica la última muestra antes de incrementar temps_index:
+    // vaciar el buffer una vez más para emitirla (igual que processes_sbi.s)
+    process3_uart_poll();
+    
     clock_gettime(CLOCK_MONOTONIC, &metrics_p3.end_time);
     return NULL;
 }
 
+// Reporte de una etapa de latencia (P1→P2 / P1→P3)
+static void print_latency_stage(const char *name, const LatencyStats *s,
+                                unsigned int superseded, int last) {
+    const char *branch = last ? "└─" : "├─";
+    const char *indent = last ? "   " : "│  ";
+    
+    // Toda muestra publicada se consume, se pisa o queda pendiente al final
+    unsigned int pending = sample_seq - s->count - superseded;
+    
+    if (s->count > 0) {
+        printf("  %s %s: n=%u, min=%u µs, avg=%.1f µs, max=%u µs\n", branch, name,
+               s->count, s->min, (double)s->sum / s->count, s->max);
+    } else {
+        printf("  %s %s: n=0\n", branch, name);
+    }
+    printf("  %s   Muestras pisadas: %u, sin consumir al final: %u\n",
+           indent, superseded, pending);
+    
+    for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+        if (s->hist[b] == 0) continue;
+        printf("  %s   [%u, %u] µs: %u\n", indent,
+               b == 0 ? 0u : 1u << b, (2u << b) - 1, s->hist[b]);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Scenario 4: Syscall-based processes (silent, count syscalls internally)
 // Same behavior as other scenarios but track syscall count for metrics
@@ -259,6 +339,12 @@ int main() {
     cooling_state = 0;
     uart_buffer = 0;
     uart_last = 0;
+    sample_stamp = 0;
+    sample_seq = 0;
+    p2_seen_seq = 0;
+    p3_seen_seq = 0;
+    superseded_p2 = 0;
+    superseded_p3 = 0;
     
     printf("\n");
     printf("═══════════════════════════════════════════════════════════\n");
@@ -414,6 +500,11 @@ int main() {
     printf("  └─ Cambios cooling_flag: múltiples transiciones\n");
     printf("\n");
     
+    printf("⏱️  LATENCIA MUESTRA → ACTUACIÓN:\n");
+    print_latency_stage("P1→P2 (cooler)", &lat_p1_p2, superseded_p2, 0);
+    print_latency_stage("P1→P3 (UART)", &lat_p1_p3, superseded_p3, 1);
+    printf("\n");
+    
     printf("╔═══════════════════════════════════════════════════════════╗\n");
     printf("║   SIMULACIÓN COMPLETADA EXITOSAMENTE                      ║\n");
     printf("╚═══════════════════════════════════════════════════════════╝\n");